@@ -0,0 +1,233 @@
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "core/engine.h"
+#include "core/profiler.h"
+#include "loops/game_loop.h"
+
+// Runs scripted GameLoop scenarios on a headless engine and reports ticks/sec and per-phase times as
+// JSON. Asset paths are relative, so run it from the repository root:
+//   ./build/hl3_bench --scenario horde_2000_maxed --ticks 600 --out result.json
+// --trace also records profiling zones of the measured ticks of every scenario into one Chrome trace.
+// Scenarios run with a fixed --seed, so two builds see the same spawns. --replay FILE instead plays back a
+// session recorded with `half_life_3 --record FILE` as fast as possible, with the seed it was recorded with.
+
+namespace {
+
+struct NamedScenario {
+  const char *name;
+  Scenario scenario;
+};
+
+std::vector<NamedScenario> makeScenarios() {
+  std::vector<NamedScenario> scenarios;
+
+  Scenario idle;
+  idle.waves = false;
+  idle.invulnerable = true;
+  scenarios.push_back({"idle", idle});
+
+  Scenario waves;
+  waves.invulnerable = true;
+  waves.autoUpgrade = true;
+  scenarios.push_back({"waves", waves});
+
+  Scenario horde;
+  horde.minotaurs = 500;
+  horde.weaponUpgrades = 3;
+  horde.waves = false;
+  horde.invulnerable = true;
+  horde.autoUpgrade = true;
+  scenarios.push_back({"horde_500", horde});
+
+  // Both weapons upgraded far past what a regular run reaches.
+  Scenario maxed = horde;
+  maxed.minotaurs = 2000;
+  maxed.weaponUpgrades = 10;
+  scenarios.push_back({"horde_2000_maxed", maxed});
+
+  return scenarios;
+}
+
+struct Options {
+  std::string scenario = "all";
+  unsigned int ticks = 600;
+  unsigned int warmup = 60;
+  int workers = -1; // keep the engine default
+  std::string out;
+  std::string trace; // Chrome trace of the measured ticks, empty for none
+  std::uint32_t seed = 1;
+  std::string replay; // recorded input to play back instead of the scenarios
+};
+
+void printUsage(const std::vector<NamedScenario> &scenarios) {
+  std::cerr << "usage: hl3_bench [--scenario NAME|all] [--ticks N] [--warmup N] [--workers N] [--out FILE]\n"
+            << "                 [--trace FILE] [--seed N] [--replay FILE]\n"
+            << "scenarios:";
+  for (const auto &s : scenarios)
+    std::cerr << ' ' << s.name;
+  std::cerr << '\n';
+}
+
+bool parseOptions(int argc, char **argv, Options &options) {
+  for (int i = 1; i < argc; ++i) {
+    if (i + 1 >= argc)
+      return false;
+    const char *value = argv[++i];
+    if (std::strcmp(argv[i - 1], "--scenario") == 0)
+      options.scenario = value;
+    else if (std::strcmp(argv[i - 1], "--ticks") == 0)
+      options.ticks = static_cast<unsigned int>(std::atoi(value));
+    else if (std::strcmp(argv[i - 1], "--warmup") == 0)
+      options.warmup = static_cast<unsigned int>(std::atoi(value));
+    else if (std::strcmp(argv[i - 1], "--workers") == 0)
+      options.workers = std::atoi(value);
+    else if (std::strcmp(argv[i - 1], "--out") == 0)
+      options.out = value;
+    else if (std::strcmp(argv[i - 1], "--trace") == 0)
+      options.trace = value;
+    else if (std::strcmp(argv[i - 1], "--seed") == 0)
+      options.seed = static_cast<std::uint32_t>(std::strtoul(value, nullptr, 10));
+    else if (std::strcmp(argv[i - 1], "--replay") == 0)
+      options.replay = value;
+    else
+      return false;
+  }
+  return options.ticks > 0;
+}
+
+double perTick(double ms, unsigned int ticks) { return ticks > 0 ? ms / ticks : 0.0; }
+
+// Reports one measured run of the active loop and removes the loop.
+std::string finishRun(engine::Engine &e,
+    GameLoop &loop,
+    const char *name,
+    std::size_t spawned,
+    float dt,
+    const engine::Engine::HeadlessStats &stats) {
+  std::ostringstream json;
+  json << "    {\n"
+       << "      \"name\": \"" << name << "\",\n"
+       << "      \"seed\": " << loop.getRandom().getSeed() << ",\n"
+       << "      \"minotaurs_spawned\": " << spawned << ",\n"
+       << "      \"ticks\": " << stats.ticks << ",\n"
+       << "      \"dt\": " << dt << ",\n"
+       << "      \"total_ms\": " << stats.totalMs << ",\n"
+       << "      \"ticks_per_sec\": " << (stats.totalMs > 0.0 ? stats.ticks * 1000.0 / stats.totalMs : 0.0)
+       << ",\n"
+       << "      \"phases_ms\": {\n"
+       << "        \"update\": " << perTick(stats.updateMs, stats.ticks) << ",\n"
+       << "        \"collect\": " << perTick(stats.collectMs, stats.ticks) << ",\n"
+       << "        \"max_tick\": " << stats.maxTickMs << "\n"
+       << "      },\n"
+       << "      \"systems_ms\": {";
+  const auto &timings = loop.getSystems().getTimings();
+  for (std::size_t i = 0; i < timings.size(); ++i) {
+    json << (i == 0 ? "\n" : ",\n") << "        \"" << timings[i].name
+         << "\": " << perTick(timings[i].totalMs, stats.ticks);
+  }
+  json << "\n      }\n    }";
+
+  e.setLoop(nullptr);
+  std::cerr << name << ": " << stats.ticks << " ticks, "
+            << (stats.totalMs > 0.0 ? stats.ticks * 1000.0 / stats.totalMs : 0.0) << " ticks/sec\n";
+  return json.str();
+}
+
+std::string runScenario(engine::Engine &e, const NamedScenario &named, const Options &options) {
+  auto owned = std::make_unique<GameLoop>(options.seed);
+  GameLoop &loop = *owned;
+  e.setLoop(std::move(owned));
+  const std::size_t spawned = loop.applyScenario(named.scenario);
+
+  const float dt = 1.f / static_cast<float>(e.getTickRate());
+  e.runHeadless(options.warmup, dt);
+  loop.getSystems().resetTimings();
+  engine::Profiler::get().setEnabled(!options.trace.empty());
+  const engine::Engine::HeadlessStats stats = e.runHeadless(options.ticks, dt);
+  engine::Profiler::get().setEnabled(false);
+  return finishRun(e, loop, named.name, spawned, dt, stats);
+}
+
+// Regular play driven by the recorded keys; no warmup, since the recording starts at the first step.
+std::string runReplay(engine::Engine &e, engine::InputReplay &replay, const Options &options) {
+  e.setTickRate(replay.getTickRate());
+  auto owned = std::make_unique<GameLoop>(replay.getSeed());
+  GameLoop &loop = *owned;
+  e.setLoop(std::move(owned));
+  Scenario play;
+  play.reports = false;
+  loop.applyScenario(play);
+
+  engine::Profiler::get().setEnabled(!options.trace.empty());
+  const engine::Engine::HeadlessStats stats = e.runReplay(replay);
+  engine::Profiler::get().setEnabled(false);
+  return finishRun(e, loop, "replay", 0, 1.f / static_cast<float>(e.getTickRate()), stats);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const std::vector<NamedScenario> scenarios = makeScenarios();
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    printUsage(scenarios);
+    return 2;
+  }
+
+  std::vector<const NamedScenario *> selected;
+  for (const auto &s : scenarios) {
+    if (options.scenario == "all" || options.scenario == s.name)
+      selected.push_back(&s);
+  }
+  if (selected.empty()) {
+    std::cerr << "unknown scenario: " << options.scenario << '\n';
+    printUsage(scenarios);
+    return 2;
+  }
+
+  engine::InputReplay replay;
+  if (!options.replay.empty() && !replay.open(options.replay)) {
+    std::cerr << "cannot read recording " << options.replay << '\n';
+    return 1;
+  }
+
+  engine::Engine *e = engine::Engine::withLoop(nullptr, engine::DisplayMode::Headless);
+  if (options.workers >= 0)
+    e->setWorkerCount(static_cast<unsigned int>(options.workers));
+
+  std::ostringstream json;
+  json << "{\n"
+       << "  \"warmup_ticks\": " << (options.replay.empty() ? options.warmup : 0u) << ",\n"
+       << "  \"scenarios\": [\n";
+  if (!options.replay.empty()) {
+    json << runReplay(*e, replay, options);
+  } else {
+    for (std::size_t i = 0; i < selected.size(); ++i)
+      json << (i == 0 ? "" : ",\n") << runScenario(*e, *selected[i], options);
+  }
+  json << "\n  ]\n}\n";
+
+  if (!options.trace.empty() && !engine::Profiler::get().saveChromeTrace(options.trace)) {
+    std::cerr << "cannot write " << options.trace << '\n';
+    return 1;
+  }
+
+  if (options.out.empty()) {
+    std::cout << json.str();
+  } else {
+    std::ofstream out(options.out);
+    if (!out) {
+      std::cerr << "cannot write " << options.out << '\n';
+      return 1;
+    }
+    out << json.str();
+  }
+  return 0;
+}
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "ecs/components.h"
+#include "resources/text_layout.h"
+#include <SFML/Graphics/Color.hpp>
 #include <SFML/Graphics/Image.hpp>
 #include <SFML/Graphics/Rect.hpp>
 #include <array>
@@ -39,6 +41,14 @@ struct UISprite {
   int zIndex = 0;
 };
 
+// Screen text drawn from a glyph atlas; the layout is only rebuilt when the string changes.
+struct UIText {
+  engine::TextLayout layout;
+  engine::Position pos;
+  sf::Color color = sf::Color::White;
+  int zIndex = 0;
+};
+
 struct UIPause {};
 struct UIGameOver {};
 
@@ -72,6 +82,7 @@ struct Weapon {
   float shotTimer = 0.f;
   unsigned int damage = 0;
   float projectileSpeed = 0.f;
+  engine::TextureId projectileTexture; // Sprite of spawned projectiles / effects
 };
 
 struct Weapons {
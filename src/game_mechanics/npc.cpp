@@ -2,23 +2,29 @@
 
 #include "components.h"
 #include "core/camera.h"
+#include "core/job_system.h"
 #include "ecs/components.h"
+#include "ecs/prefab.h"
 #include "ecs/systems.h"
 #include "random/random_positions.h"
+#include "resources/animation_library.h"
 
 #include <SFML/System/Vector2.hpp>
 #include <cassert>
 #include <cmath>
 #include <entt/entt.hpp>
-#include <unordered_map>
+#include <vector>
 
 entt::entity gameCreateNPC(entt::registry &registry,
     const sf::Vector2f &pos,
     const sf::Vector2f &targetSize,
     float speed,
     unsigned int hp,
-    const std::unordered_map<int, engine::AnimationClip> &clips) {
+    const engine::AnimationLibrary &animations,
+    engine::AnimationSetId set) {
+  const engine::AnimationSet &clips = animations.get(set);
   assert(!clips.empty() && "NPC must have at least one animation clip!");
+  const engine::AnimationClip &first = *clips.find(clips.getDefaultState());
 
   auto e = registry.create();
   registry.emplace<engine::Position>(e, pos);
@@ -27,89 +33,105 @@ entt::entity gameCreateNPC(entt::registry &registry,
   registry.emplace<HP>(e, HP{hp, hp});
 
   engine::Renderable render;
-  render.textureName = clips.begin()->second.texture;
-  render.textureRect = clips.begin()->second.frameRect;
+  render.texture = first.texture;
+  render.textureRect = first.frameRect;
   render.targetSize = targetSize;
   registry.emplace<engine::Renderable>(e, std::move(render));
   engine::Animation anim;
-  anim.clips = clips;
-  anim.state = clips.begin()->first;
-  registry.emplace<engine::Animation>(e, std::move(anim));
+  anim.set = set;
+  anim.state = clips.getDefaultState();
+  registry.emplace<engine::Animation>(e, anim);
   return e;
 }
 
-entt::entity spawnMinotaurInRing(entt::registry &registry,
+engine::Prefab makeMinotaurPrefab(const engine::AnimationLibrary &animations, engine::AnimationSetId set) {
+  const engine::AnimationSet &clips = animations.get(set);
+  assert(!clips.empty() && "NPC must have at least one animation clip!");
+  const engine::AnimationClip &first = *clips.find(clips.getDefaultState());
+
+  engine::Renderable render;
+  render.texture = first.texture;
+  render.textureRect = first.frameRect;
+  render.targetSize = {60.f, 60.f};
+
+  engine::Animation anim;
+  anim.set = set;
+  anim.state = clips.getDefaultState();
+
+  engine::Prefab prefab;
+  prefab.with<engine::Speed>(engine::Speed{60.f})
+      .with<engine::Velocity>()
+      .with<engine::Renderable>(render)
+      .with<engine::Animation>(anim)
+      .with<SideViewOnly>()
+      .with<engine::ChasingPlayer>()
+      .with<engine::CastsShadow>()
+      .with<Solid>(Solid{true});
+  return prefab;
+}
+
+std::size_t spawnMinotaursInRing(entt::registry &registry,
+    const engine::Prefab &prefab,
+    std::size_t count,
     unsigned int maxHp,
     unsigned int collisionDamage,
     const sf::Vector2f &playerPos,
     float innerRadius,
     float outerRadius,
-    int worldWidth,
-    int worldHeight) {
-  sf::Vector2f spawnPos;
-  float innerSq = innerRadius * innerRadius;
-  float outerSq = outerRadius * outerRadius;
-
-  const int maxTries = 1024;
-  int tries = 0;
-
-  while (true) {
-    const float margin = 1.f;
-    spawnPos = randomPointOnMap(worldWidth, worldHeight, margin);
-    sf::Vector2f diff = spawnPos - playerPos;
-    float d2 = diff.x * diff.x + diff.y * diff.y;
-    if (d2 >= innerSq && d2 <= outerSq)
-      break;
-
-    if (++tries >= maxTries) {
-      spawnPos = playerPos + sf::Vector2f{outerRadius, 0.f};
-      break;
-    }
-  }
-
-  sf::Vector2f minoSize{60.f, 60.f};
-  sf::IntRect minoRect({0, 0}, {60, 60});
-
-  std::unordered_map<int, engine::AnimationClip> npcClips = {
-      {0, {"assets/npc/minotaur_idle.png", 12, 0.08f, minoRect}},
-      {1, {"assets/npc/minotaur_walk.png", 18, 0.08f, minoRect}}};
-
-  auto minotaur = systems::createNPC(registry, spawnPos, minoSize, npcClips, 60.f);
-  registry.emplace<SideViewOnly>(minotaur);
-  registry.emplace<engine::ChasingPlayer>(minotaur);
-  registry.emplace<engine::CastsShadow>(minotaur);
-  registry.emplace<HP>(minotaur, HP{maxHp, maxHp});
-  registry.emplace<NpcCollisionDamage>(minotaur, NpcCollisionDamage{collisionDamage});
-  registry.emplace<Solid>(minotaur, Solid{true});
-
-  return minotaur;
+    const engine::TileMap &tiles,
+    engine::Random &random) {
+  const float margin = 1.f;
+  std::vector<sf::Vector2f> points;
+  points.reserve(count);
+  randomPointsInRing(random, playerPos, innerRadius, outerRadius, margin, tiles, count, points);
+  if (points.empty())
+    return 0;
+
+  std::vector<engine::Position> positions;
+  positions.reserve(points.size());
+  for (const auto &point : points)
+    positions.push_back(engine::Position{point});
+
+  std::vector<entt::entity> minotaurs;
+  minotaurs.reserve(points.size());
+  prefab.spawn(registry, points.size(), minotaurs);
+
+  registry.insert<engine::Position>(minotaurs.begin(), minotaurs.end(), positions.begin());
+  registry.insert<HP>(minotaurs.begin(), minotaurs.end(), HP{maxHp, maxHp});
+  registry.insert<NpcCollisionDamage>(
+      minotaurs.begin(), minotaurs.end(), NpcCollisionDamage{collisionDamage});
+  return minotaurs.size();
 }
 
-void gameNpcFollowPlayerSystem(entt::registry &registry, engine::Camera &camera) {
+void gameNpcFollowPlayerSystem(entt::registry &registry, engine::Camera &camera, engine::JobSystem &jobs) {
   auto playerView = registry.view<const engine::Position, const engine::PlayerControlled>();
   const auto playerEntity = *playerView.begin();
   const auto &playerPos = playerView.get<const engine::Position>(playerEntity);
+  const sf::Vector2f playerScreen = camera.worldToScreen(playerPos.value);
 
   auto npcView =
-      registry.view<const engine::Position, engine::Velocity, engine::Speed, engine::ChasingPlayer>();
-
-  for (auto npc : npcView) {
-    const auto &pos = npcView.get<const engine::Position>(npc);
-    auto &vel = npcView.get<engine::Velocity>(npc);
-    const auto &speed = npcView.get<const engine::Speed>(npc);
-
-    sf::Vector2f playerScreen = camera.worldToScreen(playerPos.value);
-    sf::Vector2f npcScreen = camera.worldToScreen(pos.value);
-    sf::Vector2f diff = playerScreen - npcScreen;
-
-    float len = std::sqrt(diff.x * diff.x + diff.y * diff.y);
-    if (len > 1.f) {
-      sf::Vector2f dir = diff / len;
-      vel.value = dir * speed.value;
-    } else {
-      vel.value = {0.f, 0.f};
+      registry.view<const engine::Position, engine::Velocity, const engine::Speed, engine::ChasingPlayer>();
+  std::vector<entt::entity> npcs(npcView.begin(), npcView.end());
+
+  // Every NPC only writes its own velocity, so chunks are independent.
+  jobs.parallelFor(npcs.size(), 256, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      const auto &pos = npcView.get<const engine::Position>(npcs[i]);
+      auto &vel = npcView.get<engine::Velocity>(npcs[i]);
+      const auto &speed = npcView.get<const engine::Speed>(npcs[i]);
+
+      sf::Vector2f npcScreen = camera.worldToScreen(pos.value);
+      sf::Vector2f diff = playerScreen - npcScreen;
+
+      float len = std::sqrt(diff.x * diff.x + diff.y * diff.y);
+      if (len > 1.f) {
+        sf::Vector2f dir = diff / len;
+        vel.value = dir * speed.value;
+      } else {
+        vel.value = {0.f, 0.f};
+      }
     }
-  }
+  });
 }
 
 unsigned int clearDeadNpc(entt::registry &registry) {
@@ -1,13 +1,19 @@
 #pragma once
 
+#include "ecs/prefab.h"
+#include "ecs/tile_map.h"
 #include <SFML/System/Vector2.hpp>
+#include <cstddef>
 #include <entt/entt.hpp>
-#include <unordered_map>
+#include <vector>
 
 namespace engine {
-struct AnimationClip;
+class AnimationLibrary;
+struct AnimationSetId;
 struct Camera;
 struct Input;
+class JobSystem;
+class Random;
 } // namespace engine
 
 entt::entity gameCreateNPC(entt::registry &registry,
@@ -15,16 +21,24 @@ entt::entity gameCreateNPC(entt::registry &registry,
     const sf::Vector2f &targetSize,
     float speed,
     unsigned int hp,
-    const std::unordered_map<int, engine::AnimationClip> &clips);
+    const engine::AnimationLibrary &animations,
+    engine::AnimationSetId set);
 
-void gameNpcFollowPlayerSystem(entt::registry &registry, engine::Camera &camera);
+void gameNpcFollowPlayerSystem(entt::registry &registry, engine::Camera &camera, engine::JobSystem &jobs);
 unsigned int clearDeadNpc(entt::registry &registry);
 
-entt::entity spawnMinotaurInRing(entt::registry &registry,
+// Components shared by every minotaur; HP and collision damage depend on the wave and are set on spawn.
+engine::Prefab makeMinotaurPrefab(const engine::AnimationLibrary &animations, engine::AnimationSetId set);
+
+// Spawns up to `count` minotaurs in one batch on walkable tiles of the ring around the player.
+// Returns the number spawned.
+std::size_t spawnMinotaursInRing(entt::registry &registry,
+    const engine::Prefab &prefab,
+    std::size_t count,
     unsigned int maxHp,
     unsigned int collisionDamage,
     const sf::Vector2f &playerPos,
     float innerRadius,
     float outerRadius,
-    int worldWidth,
-    int worldHeight);
+    const engine::TileMap &tiles,
+    engine::Random &random);
@@ -1,11 +1,13 @@
 #include "game_loop.h"
 
+#include <algorithm>
 #include <random>
 
 #include "cmath"
 #include "components.h"
 #include "core/camera.h"
 #include "core/engine.h"
+#include "core/profiler.h"
 #include "core/render.h"
 #include "core/render_frame.h"
 #include "ecs/components.h"
@@ -16,15 +18,14 @@
 #include "game_mechanics/weapons.h"
 #include "random/random_positions.h"
 #include "render/colorDmg.h"
-#include "render/textToImage.h"
 #include "render/ui_render.h"
 #include "render/weapon_textures.h"
 #include "resources/image_manager.h"
 #include "systems.h"
 #include <SFML/Graphics/Color.hpp>
 #include <SFML/Graphics/Font.hpp>
-#include <algorithm>
 #include <cstdio>
+#include <iostream>
 
 namespace {
 
@@ -49,13 +50,17 @@ const std::vector<UpgradeDef> ALL_UPGRADES = {
 
 const unsigned int DEFAULT_UI_TEXT_SIZE = 30;
 const unsigned int TIMER_TEXT_SIZE = 40;
+const unsigned int STATS_TEXT_SIZE = 20;
+const char *const TRACE_FILE = "trace.json";
 
-GameLoop::GameLoop() {
-  engine::WorldLoader::loadWorldFromJson("assets/worlds/meadow.json", width, height, tileTextures, tiles);
+GameLoop::GameLoop(std::uint32_t seed) : m_random(seed) {
+  engine::WorldLoader::loadWorld("assets/worlds/meadow.json", width, height, tileTextures, tiles);
 }
 
 void GameLoop::init() {
   m_engine = engine::Engine::get();
+  m_registry.on_destroy<Solid>().connect<&engine::SpatialHashGrid::onDestroy>(m_solidGrid);
+  registerSystems();
   m_engine->camera.size = {1200.f, 800.f};
   m_engine->render.getWindow().setSize({1200u, 800u});
 
@@ -67,33 +72,24 @@ void GameLoop::init() {
   const int tileHeight = 32.f;
   m_engine->camera.setTileSize(tileWidth, tileHeight);
 
-  auto tileImages = engine::makeTileData(tileTextures, m_engine->imageManager);
-
-  std::vector<engine::Tile> staticTiles = tiles;
-  for (int y = 0; y < height; ++y) {
-    for (int x = 0; x < width; ++x) {
-      const auto &tile = tiles[y * width + x];
-      std::vector<int> groundLayers;
-
-      for (int key : tile.layerIds) {
-        const auto &texInfo = tileTextures.at(key);
+  // Decode everything known up front on the loader threads; the tiles are waited for right below.
+  m_engine->imageManager.prefetchManifest("assets/prefetch.txt");
+  std::vector<std::string> tilePaths;
+  for (const auto &[id, texInfo] : tileTextures)
+    tilePaths.push_back(texInfo.texture_src);
+  m_engine->imageManager.prefetch(tilePaths);
 
-        if (texInfo.is_ground) {
-          groundLayers.push_back(key);
-        } else {
-          sf::Vector2f worldPos = {(float)x + 2.f, (float)y + 1.f};
-
-          auto stObject = systems::createStaticObject(
-              m_registry, worldPos, {32.f, 32.f}, texInfo.texture_src, sf::IntRect({0, 0}, {32, 32}));
-          m_registry.emplace<engine::CastsShadow>(stObject);
-        }
-      }
-      staticTiles[y * width + x].layerIds = std::move(groundLayers);
-    }
-  }
+  auto tileImages = engine::makeTileData(tileTextures, m_engine->imageManager);
 
-  m_engine->render.generateTileMapVertices(
-      m_tileMeshes, m_engine->camera, staticTiles, width, height, tileImages);
+  // Ground layers are baked around the camera; everything standing on a tile becomes a static object
+  // while its chunk is near the camera, see streamStaticObjects().
+  auto isGround = [&](int key) { return tileTextures.at(key).is_ground; };
+  m_tileStreamer.setWorld(tiles.filterLayers(isGround), std::move(tileImages), m_engine->camera);
+  const int chunkSize = m_tileStreamer.getChunkSize();
+  const std::size_t chunkCount =
+      static_cast<std::size_t>((width + chunkSize - 1) / chunkSize) * ((height + chunkSize - 1) / chunkSize);
+  m_chunkObjects.assign(chunkCount, {});
+  m_chunkHasObjects.assign(chunkCount, false);
 
   spawnStaticObjects(200);
 
@@ -101,13 +97,23 @@ void GameLoop::init() {
   sf::Vector2f mainSize{56.f, 60.f};
   sf::IntRect mainRect({0, 0}, {56, 60});
 
-  std::unordered_map<int, engine::AnimationClip> mainHeroClips = {
-      {0, {"assets/npc/main_idle.png", 12, 0.15f, mainRect}},
-      {1, {"assets/npc/main_walk.png", 6, 0.08f, mainRect}},
-  };
+  engine::AnimationSet mainHeroClips;
+  mainHeroClips.addClip(0, {m_engine->imageManager.getId("assets/npc/main_idle.png"), 12, 0.15f, mainRect});
+  mainHeroClips.addClip(1, {m_engine->imageManager.getId("assets/npc/main_walk.png"), 6, 0.08f, mainRect});
+  const engine::AnimationSetId mainHeroSet = m_engine->animations.add(std::move(mainHeroClips));
+
+  sf::IntRect minoRect({0, 0}, {60, 60});
+  engine::AnimationSet minotaurClips;
+  minotaurClips.addClip(
+      0, {m_engine->imageManager.getId("assets/npc/minotaur_idle.png"), 12, 0.08f, minoRect});
+  minotaurClips.addClip(
+      1, {m_engine->imageManager.getId("assets/npc/minotaur_walk.png"), 18, 0.08f, minoRect});
+  m_minotaurPrefab =
+      makeMinotaurPrefab(m_engine->animations, m_engine->animations.add(std::move(minotaurClips)));
 
   sf::Vector2f playerStartPos{width / 2.f, height / 2.f};
-  auto main_hero = systems::createNPC(m_registry, playerStartPos, mainSize, mainHeroClips, 200.f);
+  auto main_hero =
+      systems::createNPC(m_registry, playerStartPos, mainSize, m_engine->animations, mainHeroSet, 200.f);
   m_registry.emplace<engine::PlayerControlled>(main_hero);
   m_registry.emplace<engine::CastsShadow>(main_hero);
   HP hp{100, 100};
@@ -138,7 +144,12 @@ void GameLoop::init() {
 
   const unsigned magicBallTexSize = 32u;
   const unsigned swordRingTexSize = 64u;
-  render::generateWeaponTextures(magicBallTexSize, swordRingTexSize);
+  render::registerWeaponTextures(
+      m_engine->imageManager, m_engine->getJobs(), magicBallTexSize, swordRingTexSize);
+  playerWeapons.slots[0].projectileTexture =
+      m_engine->imageManager.getId(std::string(render::MAGIC_BALL_TEXTURE));
+  playerWeapons.slots[1].projectileTexture =
+      m_engine->imageManager.getId(std::string(render::SWORD_RING_TEXTURE));
 
   m_registry.emplace<Weapons>(main_hero, playerWeapons);
 
@@ -147,6 +158,14 @@ void GameLoop::init() {
     throw std::runtime_error("Failed to load font for UI");
   }
 
+  // Glyphs are rasterized once; HUD text is drawn as quads from these atlases. Rasterizing needs a GPU
+  // context, so headless runs lay out text without glyphs.
+  if (!m_engine->render.isHeadless()) {
+    uiGlyphs.hud.build(uiFont, DEFAULT_UI_TEXT_SIZE);
+    uiGlyphs.timer.build(uiFont, TIMER_TEXT_SIZE);
+    uiGlyphs.stats.build(uiFont, STATS_TEXT_SIZE);
+  }
+
   uiEntities.hp = m_registry.create();
   uiEntities.exp = m_registry.create();
   uiEntities.kills = m_registry.create();
@@ -154,62 +173,139 @@ void GameLoop::init() {
   uiEntities.gameSpeed = m_registry.create();
   uiEntities.pause = entt::null;
 
-  std::string hpText = "HP " + std::to_string(hp.current) + "/" + std::to_string(hp.max);
-  uiAssets.hp = textToImage(hpText, uiFont, DEFAULT_UI_TEXT_SIZE, sf::Color::Red);
-  std::string expText = "Level " + std::to_string(exp.level) + " " + std::to_string(exp.currentXp) + "/" +
-                        std::to_string(exp.xpToNextLevel);
-  uiAssets.exp = textToImage(expText, uiFont, DEFAULT_UI_TEXT_SIZE, sf::Color::Cyan);
-  uiAssets.kills = textToImage("Kills 0", uiFont, DEFAULT_UI_TEXT_SIZE, sf::Color::White);
-  uiAssets.timer = textToImage("00:00", uiFont, DEFAULT_UI_TEXT_SIZE, sf::Color::White);
-  {
-    char buf[16];
-    std::snprintf(buf, sizeof(buf), "%.1f", static_cast<double>(gameSpeed));
-    uiAssets.gameSpeed =
-        textToImage(std::string("Game speed ") + buf + "x", uiFont, DEFAULT_UI_TEXT_SIZE, sf::Color::White);
+  uiAssets.pause = m_engine->imageManager.getId("assets/ui/pause.png");
+  upgradeUi.panel = m_engine->imageManager.getId("assets/ui/upgrade.png");
+
+  UIText hpLabel{engine::TextLayout(uiGlyphs.hud)};
+  hpLabel.color = sf::Color::Red;
+  hpLabel.pos = engine::Position{sf::Vector2f{10.f, 10.f}};
+  UIText expLabel{engine::TextLayout(uiGlyphs.hud)};
+  expLabel.color = sf::Color::Cyan;
+  expLabel.pos = engine::Position{sf::Vector2f{10.f, 40.f}};
+  UIText killsLabel{engine::TextLayout(uiGlyphs.hud)};
+  killsLabel.pos = engine::Position{sf::Vector2f{10.f, 70.f}};
+  UIText timerLabel{engine::TextLayout(uiGlyphs.timer)};
+  timerLabel.pos = engine::Position{sf::Vector2f{m_engine->camera.size.x / 2.f - 60.f, 10.f}};
+  UIText speedLabel{engine::TextLayout(uiGlyphs.hud)};
+  speedLabel.pos = engine::Position{sf::Vector2f{m_engine->camera.size.x - 280.f, 10.f}};
+
+  m_registry.emplace<UIText>(uiEntities.hp, hpLabel);
+  m_registry.emplace<UIText>(uiEntities.exp, expLabel);
+  m_registry.emplace<UIText>(uiEntities.kills, killsLabel);
+  m_registry.emplace<UIText>(uiEntities.timer, timerLabel);
+  m_registry.emplace<UIText>(uiEntities.gameSpeed, speedLabel);
+
+  // Fill the labels right away instead of after the first HUD interval.
+  uiTimer = 0.3;
+  updateHUD();
+  streamStaticObjects();
+}
+
+void GameLoop::update(const engine::Input &input, float dt) {
+  // F9 starts a profiler capture and, pressed again, saves it for chrome://tracing or Perfetto.
+  const bool traceKeyDown = input.isKeyDown(sf::Keyboard::Key::F9);
+  if (traceKeyDown && !m_traceKeyDown) {
+    engine::Profiler &profiler = engine::Profiler::get();
+    if (!profiler.isEnabled()) {
+      profiler.clear();
+      profiler.setEnabled(true);
+      std::cout << "profiler: capturing, press F9 again to save\n";
+    } else {
+      profiler.setEnabled(false);
+      if (profiler.saveChromeTrace(TRACE_FILE))
+        std::cout << "profiler: saved " << TRACE_FILE << ", " << profiler.getDroppedZones()
+                  << " zones dropped\n";
+      else
+        std::cerr << "profiler: cannot write " << TRACE_FILE << '\n';
+    }
   }
+  m_traceKeyDown = traceKeyDown;
 
-  uiAssets.gameOver =
-      textToImage("You died\nPress Esc to quit", uiFont, DEFAULT_UI_TEXT_SIZE, sf::Color::White);
-
-  bool pauseLoaded = uiAssets.pause.loadFromFile("assets/ui/pause.png");
-  (void)pauseLoaded;
-
-  bool upgradeLoaded = upgradeUi.panel.loadFromFile("assets/ui/upgrade.png");
-  (void)upgradeLoaded;
-
-  UISprite uiHP{};
-  uiHP.image = &uiAssets.hp;
-  uiHP.pos = engine::Position{sf::Vector2f{10.f, 10.f}};
-  UISprite uiExp{};
-  uiExp.image = &uiAssets.exp;
-  uiExp.pos = engine::Position{sf::Vector2f{10.f, 40.f}};
-  UISprite uiKills{};
-  uiKills.image = &uiAssets.kills;
-  uiKills.pos = engine::Position{sf::Vector2f{10.f, 70.f}};
-  UISprite uiTimer{};
-  uiTimer.image = &uiAssets.timer;
-  uiTimer.pos = engine::Position{sf::Vector2f{m_engine->camera.size.x / 2.f - 60.f, 10.f}};
-  UISprite uiGameSpeed{};
-  uiGameSpeed.image = &uiAssets.gameSpeed;
-  uiGameSpeed.pos = engine::Position{sf::Vector2f{m_engine->camera.size.x - 280.f, 10.f}};
-
-  m_registry.emplace<UISprite>(uiEntities.hp, uiHP);
-  m_registry.emplace<UISprite>(uiEntities.exp, uiExp);
-  m_registry.emplace<UISprite>(uiEntities.kills, uiKills);
-  m_registry.emplace<UISprite>(uiEntities.timer, uiTimer);
-  m_registry.emplace<UISprite>(uiEntities.gameSpeed, uiGameSpeed);
+  systems::storePreviousPositions(m_registry);
+
+  int substeps = std::max(1, static_cast<int>(gameSpeed));
+  for (int i = 0; i < substeps && !m_finished; ++i) {
+    step(input, gameSpeed > 0.f ? dt : 0.f);
+  }
+
+  if (m_scenario.reports && m_systemReportClock.getElapsedTime().asSeconds() >= 5.f) {
+    m_systems.report(std::cout, m_engine->getJobs().getWorkerCount());
+    m_systems.resetTimings();
+    m_systemReportClock.restart();
+  }
 }
 
-void GameLoop::update(engine::Input &input, float dt) {
-  dt *= gameSpeed;
+namespace {
+template <typename... Components> void createPools(entt::registry &registry) {
+  (registry.storage<Components>(), ...);
+}
+} // namespace
+
+void GameLoop::registerSystems() {
+  // Movement and animation share a stage. A non-const registry creates a component's pool on first
+  // lookup, which EnTT does not synchronise, so every pool either touches exists before they run.
+  createPools<engine::Position, engine::Velocity, engine::Renderable, engine::Animation, Solid,
+      SideViewOnly, engine::ChasingPlayer, NpcCollisionDamage, engine::PlayerControlled, HP,
+      LastDamageTime>(m_registry);
+
+  // Registration order is the order the systems used to run in; the scheduler only overlaps systems
+  // whose declared data does not conflict. Animation is registered before projectile damage so it can
+  // share a stage with movement: it only reads velocities, which damage never changes.
+  m_systems
+      .add("input",
+          [this](engine::JobSystem &) { gameInputSystem(m_registry, *m_stepInput, m_keyPresses, gameSpeed); })
+      .reads<engine::Speed, engine::PlayerControlled>()
+      .writes<engine::Velocity, engine::Animation>();
+  m_systems
+      .add("npc_follow",
+          [this](engine::JobSystem &jobs) { gameNpcFollowPlayerSystem(m_registry, m_engine->camera, jobs); })
+      .reads<engine::Position, engine::PlayerControlled, engine::Speed, engine::ChasingPlayer>()
+      .writes<engine::Velocity>();
+  m_systems
+      .add("weapons",
+          [this](engine::JobSystem &) {
+            gameWeaponSystem(m_registry, m_stepDt, m_engine->camera, m_enemyIndex, m_nearestHits);
+          })
+      .structural();
+  m_systems
+      .add("movement",
+          [this](engine::JobSystem &) {
+            gameMovementSystem(m_registry, tiles, m_stepDt, globalTimer, m_engine->camera, m_solidGrid);
+          })
+      .reads<engine::Velocity, engine::Renderable, Solid, engine::ChasingPlayer, NpcCollisionDamage,
+          engine::PlayerControlled>()
+      .writes<engine::Position, HP, LastDamageTime, engine::SpatialHashGrid>();
+  m_systems
+      .add("animation",
+          [this](engine::JobSystem &jobs) {
+            gameAnimationSystem(m_registry, m_engine->animations, m_stepDt, jobs);
+          })
+      .reads<engine::Velocity, engine::Renderable, SideViewOnly>()
+      .writes<engine::Animation>();
+  m_systems
+      .add("projectile_damage",
+          [this](engine::JobSystem &) {
+            gameProjectileDamageSystem(m_registry, m_stepDt, m_engine->camera, m_npcHitboxes);
+          })
+      .structural();
+}
 
+void GameLoop::step(const engine::Input &input, float dt) {
+  ENGINE_PROFILE_ZONE("GameLoop::step");
   globalTimer += dt;
   spawnTimer += dt;
   uiTimer += dt;
 
-  engine::Camera &camera = m_engine->camera;
   auto playerView = m_registry.view<const engine::Position, Experience, engine::PlayerControlled>();
 
+  if (m_scenario.invulnerable) {
+    auto view = m_registry.view<HP, const engine::PlayerControlled>();
+    for (auto e : view) {
+      HP &hp = view.get<HP>(e);
+      hp.current = hp.max;
+    }
+  }
+
   // Game over handling: if player HP is zero, show message and wait for exit.
   auto playerHpView = m_registry.view<const HP, const engine::PlayerControlled>();
   if (playerHpView.begin() != playerHpView.end()) {
@@ -245,13 +341,11 @@ void GameLoop::update(engine::Input &input, float dt) {
 
     updateHUD();
   } else {
-    spawnMinotaurs();
-    gameInputSystem(m_registry, input, gameSpeed);
-    gameNpcFollowPlayerSystem(m_registry, camera);
-    gameWeaponSystem(m_registry, dt, m_engine->camera);
-    gameMovementSystem(m_registry, tiles, width, height, dt, globalTimer, m_engine->camera);
-    gameProjectileDamageSystem(m_registry, dt, m_engine->camera);
-    gameAnimationSystem(m_registry, dt);
+    if (m_scenario.waves)
+      spawnMinotaurs();
+    m_stepInput = &input;
+    m_stepDt = dt;
+    m_systems.run(m_engine->getJobs());
     updatePlayerDamageColor(m_registry, globalTimer);
 
     auto regenView = m_registry.view<HP, HpRegen>();
@@ -281,7 +375,11 @@ void GameLoop::update(engine::Input &input, float dt) {
       ++levelUps;
     }
     pendingLevelUps += levelUps;
-    if (pendingLevelUps > 0 && !upgradeMenuActive) {
+    if (m_scenario.autoUpgrade) {
+      // Cycle through the upgrades so unattended runs stay reproducible.
+      for (; pendingLevelUps > 0; --pendingLevelUps)
+        applyUpgrade(ALL_UPGRADES[(exp.level - pendingLevelUps) % ALL_UPGRADES.size()].kind);
+    } else if (pendingLevelUps > 0 && !upgradeMenuActive) {
       openUpgradeMenu();
     }
 
@@ -291,23 +389,67 @@ void GameLoop::update(engine::Input &input, float dt) {
   // Move camera
   const auto &pos = playerView.get<const engine::Position>(*(playerView.begin()));
   m_engine->camera.position = m_engine->camera.worldToScreen(pos.value);
+  streamStaticObjects();
 }
 
 void GameLoop::collectRenderData(engine::RenderFrame &frame, engine::Camera &camera) {
-  m_engine->render.renderMap(m_tileMeshes, camera, sf::Vector2i({width, height}), frame.tileBatches);
-  systems::renderSystem(m_registry, frame, camera, m_engine->imageManager);
+  ENGINE_PROFILE_ZONE("GameLoop::collectRenderData");
+  // Follow the player between simulation steps as well.
+  auto playerView = m_registry.view<const engine::Position, const engine::PreviousPosition,
+      engine::PlayerControlled>();
+  for (auto player : playerView) {
+    sf::Vector2f pos = engine::interpolate(playerView.get<const engine::PreviousPosition>(player).value,
+        playerView.get<const engine::Position>(player).value, frame.alpha);
+    camera.position = camera.worldToScreen(pos);
+  }
+
+  m_tileStreamer.update(camera, frame.tileChunks);
+  frame.chunkStats = m_tileStreamer.getStats();
+  systems::renderSystem(m_registry, frame, camera, m_engine->imageManager, m_engine->animations,
+      m_engine->shadowCache, m_depthOrder);
   uiRender(m_registry, frame, camera);
 }
 
 bool GameLoop::isFinished() const { return m_finished; }
 
-sf::Image GameLoop::timerImage() {
+std::size_t GameLoop::applyScenario(const Scenario &scenario) {
+  m_scenario = scenario;
+
+  for (unsigned int i = 0; i < scenario.weaponUpgrades; ++i) {
+    applyUpgrade(UpgradeKind::Damage);
+    applyUpgrade(UpgradeKind::Radius);
+    applyUpgrade(UpgradeKind::Cooldown);
+    applyUpgrade(UpgradeKind::ExtraProjectiles);
+  }
+
+  if (scenario.minotaurs == 0)
+    return 0;
+  auto playerView = m_registry.view<const engine::Position, const engine::PlayerControlled>();
+  sf::Vector2f playerPos = playerView.get<const engine::Position>(*(playerView.begin())).value;
+  return spawnMinotaursInRing(m_registry,
+      m_minotaurPrefab,
+      scenario.minotaurs,
+      22, // hp of the first waves
+      12, // dmg of the first waves
+      playerPos,
+      4.f,  // inner spawn radius
+      30.f, // outer spawn radius, wide enough for large hordes
+      tiles,
+      m_random);
+}
+
+std::string GameLoop::timerText() const {
   int time = static_cast<int>(globalTimer);
   int minutes = time / 60;
   int seconds = time % 60;
   char text[6];
   std::snprintf(text, sizeof(text), "%02d:%02d", minutes, seconds);
-  return textToImage(std::string(text), uiFont, TIMER_TEXT_SIZE, sf::Color::White);
+  return text;
+}
+
+void GameLoop::setUIText(entt::entity entity, const std::string &text) {
+  if (auto *ui = m_registry.try_get<UIText>(entity))
+    ui->layout.setString(text);
 }
 
 void GameLoop::updateUI() {
@@ -322,16 +464,16 @@ void GameLoop::updateGameOverOverlay() {
   }
 
   auto e = m_registry.create();
-  UISprite sprite{};
-  sprite.image = &uiAssets.gameOver;
+  UIText text{engine::TextLayout(uiGlyphs.hud)};
+  text.layout.setString("You died\nPress Esc to quit");
 
-  float w = static_cast<float>(uiAssets.gameOver.getSize().x);
-  float h = static_cast<float>(uiAssets.gameOver.getSize().y);
-  sprite.pos = engine::Position{
+  float w = text.layout.getSize().x;
+  float h = text.layout.getSize().y;
+  text.pos = engine::Position{
       {m_engine->camera.size.x * 0.5f - w * 0.5f, m_engine->camera.size.y * 0.5f - h * 0.5f}};
-  sprite.zIndex = 10;
+  text.zIndex = 10;
 
-  m_registry.emplace<UISprite>(e, sprite);
+  m_registry.emplace<UIText>(e, std::move(text));
   m_registry.emplace<UIGameOver>(e);
   uiEntities.gameOver = e;
 }
@@ -342,24 +484,19 @@ void GameLoop::updateHUD() {
   }
   auto playerView = m_registry.view<const engine::PlayerControlled, const HP, const Experience>();
   HP hp = playerView.get<HP>(*(playerView.begin()));
-  uiAssets.hp = textToImage("HP " + std::to_string(hp.current) + "/" + std::to_string(hp.max),
-      uiFont,
-      DEFAULT_UI_TEXT_SIZE,
-      sf::Color::Red);
+  setUIText(uiEntities.hp, "HP " + std::to_string(hp.current) + "/" + std::to_string(hp.max));
 
   Experience exp = playerView.get<Experience>(*(playerView.begin()));
   std::string expText = "Level " + std::to_string(exp.level) + " " + std::to_string(exp.currentXp) + "/" +
                         std::to_string(exp.xpToNextLevel);
-  uiAssets.exp = textToImage(expText, uiFont, DEFAULT_UI_TEXT_SIZE, sf::Color::Cyan);
+  setUIText(uiEntities.exp, expText);
 
-  uiAssets.kills =
-      textToImage("Kills " + std::to_string(kills), uiFont, DEFAULT_UI_TEXT_SIZE, sf::Color::White);
-  uiAssets.timer = timerImage();
+  setUIText(uiEntities.kills, "Kills " + std::to_string(kills));
+  setUIText(uiEntities.timer, timerText());
   {
     char buf[16];
     std::snprintf(buf, sizeof(buf), "%.1f", static_cast<double>(gameSpeed));
-    uiAssets.gameSpeed =
-        textToImage(std::string("Game speed ") + buf + "x", uiFont, DEFAULT_UI_TEXT_SIZE, sf::Color::White);
+    setUIText(uiEntities.gameSpeed, std::string("Game speed ") + buf + "x");
   }
 
   uiTimer = 0.0;
@@ -379,13 +516,14 @@ void GameLoop::updatePauseOverlay() {
                   m_registry.all_of<UISprite, UIPause>(uiEntities.pause);
 
   if (gameSpeed == 0.0f) {
-    if (!hasPause && uiAssets.pause.getSize().x > 0 && uiAssets.pause.getSize().y > 0) {
+    sf::Image &pauseImage = m_engine->imageManager.wait(uiAssets.pause);
+    if (!hasPause && pauseImage.getSize().x > 0 && pauseImage.getSize().y > 0) {
       auto e = m_registry.create();
       UISprite sprite{};
-      sprite.image = &uiAssets.pause;
+      sprite.image = &pauseImage;
 
-      float w = static_cast<float>(uiAssets.pause.getSize().x);
-      float h = static_cast<float>(uiAssets.pause.getSize().y);
+      float w = static_cast<float>(pauseImage.getSize().x);
+      float h = static_cast<float>(pauseImage.getSize().y);
       sprite.pos = engine::Position{
           {m_engine->camera.size.x * 0.5f - w * 0.5f, m_engine->camera.size.y * 0.5f - h * 0.5f}};
       sprite.zIndex = 2;
@@ -467,22 +605,22 @@ void GameLoop::updateStatsPanel() {
       xpMultiplier,
       mobSpawnMultiplier);
 
-  uiAssets.stats = textToImage(buf, uiFont, 20, sf::Color::White);
-
   if (uiEntities.stats == entt::null || !m_registry.valid(uiEntities.stats)) {
     auto e = m_registry.create();
-    UISprite sprite{};
-    sprite.image = &uiAssets.stats;
-    sprite.pos = engine::Position{
+    UIText text{engine::TextLayout(uiGlyphs.stats)};
+    text.pos = engine::Position{
         sf::Vector2f{m_engine->camera.size.x - 280.f, m_engine->camera.size.y * 0.5f - 150.f}};
     // Draw stats above pause background.
-    sprite.zIndex = 3;
-    m_registry.emplace<UISprite>(e, sprite);
+    text.zIndex = 3;
+    m_registry.emplace<UIText>(e, std::move(text));
     uiEntities.stats = e;
   }
+  // Runs every tick while paused; unchanged stats are not laid out again.
+  setUIText(uiEntities.stats, buf);
 }
 
 void GameLoop::spawnMinotaurs() {
+  ENGINE_PROFILE_ZONE("GameLoop::spawnMinotaurs");
   auto playerView = m_registry.view<const engine::Position, const engine::PlayerControlled>();
   sf::Vector2f playerPos = playerView.get<const engine::Position>(*(playerView.begin())).value;
 
@@ -499,17 +637,85 @@ void GameLoop::spawnMinotaurs() {
 
   const unsigned int hp = 20 + (multiplier * 2);
   const unsigned int dmg = 10 + (multiplier * 2);
-  for (int i = 0; i < count; ++i) {
-    spawnMinotaurInRing(m_registry,
-        hp,
-        dmg,
-        playerPos,
-        4.f,  // inner spawn radius
-        12.f, // outer spawn radius
-        width,
-        height);
+  spawnMinotaursInRing(m_registry,
+      m_minotaurPrefab,
+      static_cast<std::size_t>(count),
+      hp,
+      dmg,
+      playerPos,
+      4.f,  // inner spawn radius
+      12.f, // outer spawn radius
+      tiles,
+      m_random);
+}
+
+void GameLoop::streamStaticObjects() {
+  ENGINE_PROFILE_ZONE("GameLoop::streamStaticObjects");
+  // Follows the simulation camera, not the chunks baked for drawing, so which objects exist depends on
+  // the steps taken alone and never on frame rate or bake timing.
+  const int chunkSize = m_tileStreamer.getChunkSize();
+  const int chunksX = (width + chunkSize - 1) / chunkSize;
+  const int chunksY = (height + chunkSize - 1) / chunkSize;
+  const sf::IntRect view = m_tileStreamer.visibleChunkRange(m_engine->camera);
+  auto grownView = [&](int margin) {
+    const int left = std::max(view.position.x - margin, 0);
+    const int top = std::max(view.position.y - margin, 0);
+    const int right = std::min(view.position.x + view.size.x + margin, chunksX);
+    const int bottom = std::min(view.position.y + view.size.y + margin, chunksY);
+    return sf::IntRect({left, top}, {std::max(right - left, 0), std::max(bottom - top, 0)});
+  };
+  // Objects appear one chunk beyond the view and go two chunks beyond it, so walking along a chunk
+  // border does not spawn and destroy them every step.
+  const sf::IntRect load = grownView(engine::ChunkStreamer::LOAD_MARGIN);
+  const sf::IntRect keep = grownView(engine::ChunkStreamer::LOAD_MARGIN + 1);
+  auto indexOf = [&](sf::Vector2i chunk) { return static_cast<std::size_t>(chunk.y) * chunksX + chunk.x; };
+
+  for (std::size_t i = 0; i < m_objectChunks.size();) {
+    const sf::Vector2i chunk = m_objectChunks[i];
+    if (keep.contains(chunk)) {
+      ++i;
+      continue;
+    }
+    auto &objects = m_chunkObjects[indexOf(chunk)];
+    for (entt::entity e : objects)
+      if (m_registry.valid(e))
+        m_registry.destroy(e);
+    objects.clear();
+    m_chunkHasObjects[indexOf(chunk)] = false;
+    m_objectChunks[i] = m_objectChunks.back();
+    m_objectChunks.pop_back();
+  }
+
+  for (int cy = load.position.y; cy < load.position.y + load.size.y; ++cy) {
+    for (int cx = load.position.x; cx < load.position.x + load.size.x; ++cx) {
+      const sf::Vector2i chunk{cx, cy};
+      if (m_chunkHasObjects[indexOf(chunk)])
+        continue;
+      m_chunkHasObjects[indexOf(chunk)] = true;
+      m_objectChunks.push_back(chunk);
+
+      auto &objects = m_chunkObjects[indexOf(chunk)];
+      const sf::IntRect range = m_tileStreamer.tileRange(chunk);
+      for (int y = range.position.y; y < range.position.y + range.size.y; ++y) {
+        for (int x = range.position.x; x < range.position.x + range.size.x; ++x) {
+          for (int key : tiles.getLayers(x, y)) {
+            const auto &texInfo = tileTextures.at(key);
+            if (texInfo.is_ground)
+              continue;
+
+            sf::Vector2f worldPos = {(float)x + 2.f, (float)y + 1.f};
+            auto stObject = systems::createStaticObject(m_registry,
+                worldPos,
+                {32.f, 32.f},
+                m_engine->imageManager.getId(texInfo.texture_src),
+                sf::IntRect({0, 0}, {32, 32}));
+            m_registry.emplace<engine::CastsShadow>(stObject);
+            objects.push_back(stObject);
+          }
+        }
+      }
+    }
   }
-  return;
 }
 
 void GameLoop::spawnStaticObjects(unsigned int count) {
@@ -538,7 +744,6 @@ void GameLoop::spawnStaticObjects(unsigned int count) {
   if (prefabs.empty() || width <= 0 || height <= 0 || count == 0u)
     return;
 
-  static std::mt19937 rng{std::random_device{}()};
   int totalWeight = 0;
   for (const auto &p : prefabs)
     totalWeight += p.weight;
@@ -550,9 +755,9 @@ void GameLoop::spawnStaticObjects(unsigned int count) {
   const float margin = 1.f;
 
   for (unsigned int i = 0; i < count; ++i) {
-    sf::Vector2f worldPos = randomPointOnMap(width, height, margin);
+    sf::Vector2f worldPos = randomPointOnMap(m_random, width, height, margin);
 
-    int w = weightDist(rng);
+    int w = weightDist(m_random);
     const char *texPath = nullptr;
     for (const auto &p : prefabs) {
       if (w < p.weight) {
@@ -564,7 +769,8 @@ void GameLoop::spawnStaticObjects(unsigned int count) {
     if (!texPath)
       continue;
 
-    sf::Image &img = m_engine->imageManager.getImage(texPath);
+    engine::TextureId texture = m_engine->imageManager.getId(texPath);
+    sf::Image &img = m_engine->imageManager.wait(texture);
     sf::Vector2u texSize = img.getSize();
     if (texSize.x == 0u || texSize.y == 0u)
       continue;
@@ -572,7 +778,7 @@ void GameLoop::spawnStaticObjects(unsigned int count) {
     sf::IntRect rect({0, 0}, {static_cast<int>(texSize.x), static_cast<int>(texSize.y)});
     sf::Vector2f targetSize{static_cast<float>(texSize.x), static_cast<float>(texSize.y)};
 
-    auto e = systems::createStaticObject(m_registry, worldPos, targetSize, texPath, rect);
+    auto e = systems::createStaticObject(m_registry, worldPos, targetSize, texture, rect);
     m_registry.emplace<engine::CastsShadow>(e);
   }
 }
@@ -581,33 +787,34 @@ void GameLoop::openUpgradeMenu() {
   upgradeMenuActive = true;
   gameSpeed = 0.f;
 
-  static std::mt19937 rng{std::random_device{}()};
   std::uniform_int_distribution<std::size_t> dist(0, ALL_UPGRADES.size() - 1);
 
   std::vector<std::size_t> indices;
   indices.reserve(3);
   while (indices.size() < 3 && indices.size() < ALL_UPGRADES.size()) {
-    std::size_t idx = dist(rng);
+    std::size_t idx = dist(m_random);
     if (std::find(indices.begin(), indices.end(), idx) == indices.end())
       indices.push_back(idx);
   }
 
+  const char *optionTexts[3]{};
   for (int i = 0; i < 3; ++i) {
     std::size_t idx = indices[i % indices.size()];
     const auto &def = ALL_UPGRADES[idx];
     upgradeUi.optionKinds[i] = def.kind;
-    upgradeUi.options[i] = textToImage(def.description, uiFont, DEFAULT_UI_TEXT_SIZE, sf::Color::White);
+    optionTexts[i] = def.description;
   }
 
-  float panelWidth = static_cast<float>(upgradeUi.panel.getSize().x);
-  float panelHeight = static_cast<float>(upgradeUi.panel.getSize().y);
+  sf::Image &panelImage = m_engine->imageManager.wait(upgradeUi.panel);
+  float panelWidth = static_cast<float>(panelImage.getSize().x);
+  float panelHeight = static_cast<float>(panelImage.getSize().y);
   float panelX = m_engine->camera.size.x * 0.5f - panelWidth * 0.5f;
   float panelY = m_engine->camera.size.y * 0.5f - panelHeight * 0.5f;
 
   if (upgradeUi.panelEntity == entt::null || !m_registry.valid(upgradeUi.panelEntity)) {
     auto e = m_registry.create();
     UISprite sprite{};
-    sprite.image = &upgradeUi.panel;
+    sprite.image = &panelImage;
     sprite.pos = engine::Position{{panelX, panelY}};
     sprite.zIndex = 3;
     m_registry.emplace<UISprite>(e, sprite);
@@ -621,17 +828,17 @@ void GameLoop::openUpgradeMenu() {
     }
 
     auto e = m_registry.create();
-    UISprite sprite{};
-    sprite.image = &upgradeUi.options[i];
+    UIText text{engine::TextLayout(uiGlyphs.hud)};
+    text.layout.setString(optionTexts[i]);
 
     // Fixed offsets inside upgrade panel (same X, stepped Y).
     float baseX = panelX + 420.f;
     float baseY = panelY + 300.f;
     float stepY = 135.f;
-    sprite.pos = engine::Position{{baseX, baseY + i * stepY}};
-    sprite.zIndex = 4;
+    text.pos = engine::Position{{baseX, baseY + i * stepY}};
+    text.zIndex = 4;
 
-    m_registry.emplace<UISprite>(e, sprite);
+    m_registry.emplace<UIText>(e, std::move(text));
     upgradeUi.optionEntities[i] = e;
   }
 }
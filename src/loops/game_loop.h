@@ -1,10 +1,22 @@
 #pragma once
 
+#include "core/chunk_streamer.h"
 #include "core/loop.h"
-#include "ecs/tile.h"
+#include "core/random.h"
+#include "core/render_frame.h"
+#include "ecs/collision.h"
+#include "ecs/components.h"
+#include "ecs/depth_order.h"
+#include "ecs/prefab.h"
+#include "ecs/spatial_grid.h"
+#include "ecs/spatial_index.h"
+#include "ecs/system_scheduler.h"
+#include "ecs/tile_map.h"
+#include "resources/glyph_atlas.h"
 #include "resources/serializable_world.h"
 #include <SFML/Graphics/Font.hpp>
-#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/System/Clock.hpp>
+#include <cstdint>
 #include <entt/entt.hpp>
 #include <vector>
 
@@ -26,6 +38,18 @@ enum class UpgradeKind {
   MobCount,
 };
 
+/**
+ * @brief Scripted setup for unattended runs, e.g. by hl3_bench.
+ */
+struct Scenario {
+  unsigned int minotaurs = 0;      ///< Spawned around the player right away
+  unsigned int weaponUpgrades = 0; ///< Rounds of damage, radius, cooldown and projectile upgrades
+  bool waves = true;               ///< Regular minotaur waves keep spawning
+  bool invulnerable = false;       ///< Player HP is kept full
+  bool autoUpgrade = false;        ///< Level-ups take an upgrade right away instead of pausing
+  bool reports = true;             ///< Periodic timing reports on stdout
+};
+
 /**
  * @brief Main game loop implementation for gameplay scene.
  *
@@ -39,8 +63,10 @@ public:
    *
    * Initializes tile map and textures from serialized world data file.
    * Loads world layout, dimensions, and tile textures from JSON configuration.
+   *
+   * @param seed Seed of everything random in the session; pass a recorded one to replay it.
    */
-  GameLoop();
+  explicit GameLoop(std::uint32_t seed = engine::Random::randomSeed());
   virtual ~GameLoop() = default;
 
   /**
@@ -52,23 +78,22 @@ public:
   void init() override;
 
   /**
-   * @brief Updates game logic for the current frame.
+   * @brief Advances the game by one fixed engine step.
    * @param input Reference to the input system for player controls.
-   * @param dt Delta time in seconds since last update.
+   * @param dt Fixed step length in seconds.
    *
-   * Processes player input, movement, animations, and camera tracking.
-   * Executes all game systems in defined order.
+   * Game speed above 1x runs that many substeps of the same dt instead of a
+   * larger one, so collisions behave the same at any speed.
    */
-  void update(engine::Input &input, float dt) override;
+  void update(const engine::Input &input, float dt) override;
 
   /**
    * @brief Collects all render data for the current frame.
    * @param frame Reference to the render frame to populate with draw commands.
    * @param camera Reference to the camera for view-relative rendering.
    *
-   * Gathers static map geometry, entity sprites, and visual elements for
-   * rendering. Combines pre-computed tile vertices with dynamic entity render
-   * data.
+   * Streams ground chunks and their static objects around the camera, then
+   * gathers entity sprites and visual elements for rendering.
    */
   void collectRenderData(engine::RenderFrame &frame, engine::Camera &camera) override;
 
@@ -78,7 +103,29 @@ public:
    */
   bool isFinished() const override;
 
+  /**
+   * @brief Applies a scripted setup; call after init().
+   * @param scenario Setup to apply.
+   * @return Number of minotaurs actually spawned.
+   */
+  std::size_t applyScenario(const Scenario &scenario);
+
+  engine::SystemScheduler &getSystems() { return m_systems; } ///< Gameplay systems and their timings
+  engine::Random &getRandom() { return m_random; }             ///< Source of every random decision
+
 private:
+  engine::SpatialHashGrid m_solidGrid; ///< Solid entities by world tile; outlives m_registry
+  engine::SpatialIndex m_enemyIndex;   ///< Per-tick snapshot of weapon targets
+  std::vector<engine::SpatialIndex::Hit> m_nearestHits; ///< Scratch of the weapon targeting queries
+  engine::SweepAndPrune m_npcHitboxes; ///< Per-tick NPC hitboxes for projectile sweeps
+  engine::DepthOrder m_depthOrder;     ///< Draw order of visible entities, kept between frames
+
+  engine::SystemScheduler m_systems;           ///< Gameplay systems run each step
+  const engine::Input *m_stepInput = nullptr; ///< Input of the step being run
+  float m_stepDt = 0.f;                       ///< Length of the step being run
+  sf::Clock m_systemReportClock;              ///< Time since the last timing report
+  bool m_traceKeyDown = false;                ///< F9 state of the previous update
+
   /**
    * @brief Container managing all game objects, their components and
    * relationships.
@@ -102,15 +149,13 @@ private:
   bool gameOverActive = false;
 
   sf::Font uiFont;
+  struct UiGlyphs {
+    engine::GlyphAtlas hud;   // HUD lines and upgrade options
+    engine::GlyphAtlas timer; // Larger timer digits
+    engine::GlyphAtlas stats; // Pause stats panel
+  } uiGlyphs;
   struct UiAssets {
-    sf::Image hp;
-    sf::Image exp;
-    sf::Image kills;
-    sf::Image timer;
-    sf::Image gameSpeed;
-    sf::Image pause;
-    sf::Image stats;
-    sf::Image gameOver;
+    engine::TextureId pause;
   } uiAssets;
   struct UiEntities {
     entt::entity hp{entt::null};
@@ -128,19 +173,34 @@ private:
   int width;                                                 ///< World width in tile units
   int height;                                                ///< World height in tile units
   std::unordered_map<int, engine::TileTexture> tileTextures; ///< Tile ID to texture data mapping
-  std::vector<sf::VertexArray> m_tileMeshes;                 ///< Cached meshes for tilemap layers
-  std::vector<engine::Tile> tiles; ///< Tile data representing world layout, collision, and layers
+  engine::ChunkStreamer m_tileStreamer;                      ///< Ground chunks around the camera
+  std::vector<std::vector<entt::entity>> m_chunkObjects;     ///< Static objects per chunk
+  std::vector<bool> m_chunkHasObjects;                       ///< Objects of the chunk exist
+  std::vector<sf::Vector2i> m_objectChunks;                  ///< Chunks whose objects exist
+  engine::TileMap tiles;                                     ///< World layout, collision, and layers
+  engine::Prefab m_minotaurPrefab; ///< Archetype of every spawned minotaur
+  Scenario m_scenario;             ///< Defaults to regular play
+  engine::Random m_random;         ///< Spawns, object placement and upgrade offers
+  engine::KeyPresses m_keyPresses; ///< Speed and pause toggles; starts fresh with the RNG
 
   struct UpgradeUI {
-    sf::Image panel;
-    sf::Image options[3];
+    engine::TextureId panel;
     entt::entity panelEntity{entt::null};
     entt::entity optionEntities[3]{entt::null, entt::null, entt::null};
     UpgradeKind optionKinds[3]{UpgradeKind::MoveSpeed, UpgradeKind::ExtraProjectiles, UpgradeKind::Damage};
   } upgradeUi;
 
+  /**
+   * @brief Runs one simulation substep.
+   *
+   * Processes player input, movement, animations, and camera tracking.
+   * Executes all game systems in defined order.
+   */
+  void step(const engine::Input &input, float dt);
+
   int getEmaFps();
-  sf::Image timerImage();
+  std::string timerText() const;
+  void setUIText(entt::entity entity, const std::string &text);
   void updateUI();
   void updateHUD();
   void updatePauseOverlay();
@@ -151,4 +211,6 @@ private:
   void applyUpgrade(UpgradeKind kind);
   void spawnMinotaurs();
   void spawnStaticObjects(unsigned int count);
+  void streamStaticObjects();
+  void registerSystems();
 };
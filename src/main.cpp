@@ -1,11 +1,38 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
 #include <memory>
 
 #include "core/engine.h"
 #include "loops/game_loop.h"
 
-int main() {
-  auto loop = std::make_unique<GameLoop>();
+int main(int argc, char **argv) {
+  // --seed N replays the spawns of an earlier session, --record FILE writes its input for hl3_bench --replay.
+  std::uint32_t seed = engine::Random::randomSeed();
+  const char *recordPath = nullptr;
+  for (int i = 1; i + 1 < argc; ++i) {
+    if (std::strcmp(argv[i], "--seed") == 0)
+      seed = static_cast<std::uint32_t>(std::strtoul(argv[i + 1], nullptr, 10));
+    else if (std::strcmp(argv[i], "--record") == 0)
+      recordPath = argv[i + 1];
+  }
+
+  auto loop = std::make_unique<GameLoop>(seed);
   engine::Engine *e = engine::Engine::withLoop(std::move(loop));
+
+  // --workers N: size of the job system, e.g. to compare system timings across core counts.
+  for (int i = 1; i + 1 < argc; ++i) {
+    if (std::strcmp(argv[i], "--workers") == 0)
+      e->setWorkerCount(static_cast<unsigned int>(std::atoi(argv[i + 1])));
+  }
+
+  if (recordPath) {
+    if (e->startRecording(recordPath, seed))
+      std::cout << "Recording input to " << recordPath << " (seed " << seed << ")\n";
+    else
+      std::cerr << "Cannot write " << recordPath << "\n";
+  }
+
   e->run();
 
   return 0;
@@ -1,9 +1,12 @@
 #include "random/random_positions.h"
 
+#include "ecs/ring_sampling.h"
+
 #include <algorithm>
+#include <cmath>
 #include <random>
 
-sf::Vector2f randomPointOnMap(int width, int height, float margin) {
+sf::Vector2f randomPointOnMap(engine::Random &random, int width, int height, float margin) {
   if (width <= 0 || height <= 0)
     return {0.f, 0.f};
 
@@ -12,9 +15,32 @@ sf::Vector2f randomPointOnMap(int width, int height, float margin) {
   float maxX = std::max(minX + 0.001f, static_cast<float>(width) - margin);
   float maxY = std::max(minY + 0.001f, static_cast<float>(height) - margin);
 
-  static std::mt19937 rng{std::random_device{}()};
   std::uniform_real_distribution<float> distX(minX, maxX);
   std::uniform_real_distribution<float> distY(minY, maxY);
 
-  return {distX(rng), distY(rng)};
+  return {distX(random), distY(random)};
+}
+
+std::size_t randomPointsInRing(engine::Random &random,
+    const sf::Vector2f &center,
+    float innerRadius,
+    float outerRadius,
+    float margin,
+    const engine::TileMap &tiles,
+    std::size_t count,
+    std::vector<sf::Vector2f> &out) {
+  const int width = tiles.getWidth();
+  const int height = tiles.getHeight();
+  if (width <= 0 || height <= 0)
+    return 0;
+
+  auto walkable = [&](sf::Vector2f p) {
+    if (p.x < margin || p.y < margin || p.x > width - margin || p.y > height - margin)
+      return false;
+
+    // Same tile the movement systems test for collision.
+    return tiles.isWalkable(static_cast<int>(std::floor(p.x)) - 1, static_cast<int>(std::floor(p.y)));
+  };
+
+  return engine::sampleRing(random, center, innerRadius, outerRadius, count, walkable, out);
 }
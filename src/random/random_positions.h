@@ -1,7 +1,25 @@
 #pragma once
 
+#include "core/random.h"
+#include "ecs/tile_map.h"
 #include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <vector>
+
+// Both draw from `random`, so a seeded loop places things the same way every run.
 
 // Returns a random point inside the map [0,width) x [0,height),
 // keeping at least `margin` distance from each border when possible.
-sf::Vector2f randomPointOnMap(int width, int height, float margin);
+sf::Vector2f randomPointOnMap(engine::Random &random, int width, int height, float margin);
+
+// Appends up to `count` random points from the ring around `center` that lie on the tile map (at
+// least `margin` from each border) and not on solid tiles. Returns how many were appended; fewer when most
+// of the ring is off the map or blocked.
+std::size_t randomPointsInRing(engine::Random &random,
+    const sf::Vector2f &center,
+    float innerRadius,
+    float outerRadius,
+    float margin,
+    const engine::TileMap &tiles,
+    std::size_t count,
+    std::vector<sf::Vector2f> &out);
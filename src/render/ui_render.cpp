@@ -5,34 +5,50 @@
 #include "core/render_frame.h"
 #include "ecs/components.h"
 
+#include <algorithm>
+#include <vector>
+
 void uiRender(entt::registry &registry, engine::RenderFrame &frame, const engine::Camera &camera) {
   sf::Vector2f viewTopLeft{
       camera.position.x - camera.size.x * 0.5f, camera.position.y - camera.size.y * 0.5f};
 
-  auto view = registry.view<const UISprite>();
+  auto sprites = registry.view<const UISprite>();
+  auto texts = registry.view<const UIText>();
+
+  // Images and text share one z order.
+  struct Item {
+    int zIndex;
+    entt::entity entity;
+    bool text;
+  };
+  std::vector<Item> items;
+  items.reserve(sprites.size_hint() + texts.size_hint());
+  for (auto entity : sprites)
+    items.push_back({sprites.get<const UISprite>(entity).zIndex, entity, false});
+  for (auto entity : texts)
+    items.push_back({texts.get<const UIText>(entity).zIndex, entity, true});
+  std::stable_sort(
+      items.begin(), items.end(), [](const Item &a, const Item &b) { return a.zIndex < b.zIndex; });
 
-  std::vector<entt::entity> entities(view.begin(), view.end());
-  std::sort(entities.begin(), entities.end(), [&](entt::entity a, entt::entity b) {
-    const auto &ua = view.get<const UISprite>(a);
-    const auto &ub = view.get<const UISprite>(b);
-    return ua.zIndex < ub.zIndex;
-  });
+  for (const auto &item : items) {
+    if (item.text) {
+      const auto &ui = texts.get<const UIText>(item.entity);
+      ui.layout.appendTo(frame, viewTopLeft + ui.pos.value, ui.color);
+      continue;
+    }
 
-  for (auto entity : entities) {
-    const auto &ui = view.get<const UISprite>(entity);
+    const auto &ui = sprites.get<const UISprite>(item.entity);
+    if (!ui.image)
+      continue;
     const auto &pos = ui.pos;
     const sf::IntRect rect({0, 0},
         {static_cast<int>(ui.image->getSize().x), static_cast<int>(ui.image->getSize().y)}); // Full image
-    if (!ui.image)
-      continue;
 
-    engine::RenderFrame::SpriteData sprite{};
+    auto &sprite = frame.sprites.emplace_back();
     sprite.image = ui.image;
     sprite.textureRect = rect;
     sprite.position = {viewTopLeft.x + pos.value.x, viewTopLeft.y + pos.value.y}; // top left
     sprite.scale = {1.f, 1.f};
     sprite.rotation = sf::Angle::Zero;
-
-    frame.sprites.push_back(sprite);
   }
 }
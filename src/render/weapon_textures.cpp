@@ -3,15 +3,18 @@
 #include <SFML/Graphics/Color.hpp>
 #include <SFML/Graphics/Image.hpp>
 #include <SFML/System/Vector2.hpp>
+#include "core/job_system.h"
+#include "resources/image_manager.h"
+
 #include <algorithm>
 #include <cmath>
-#include <filesystem>
+#include <string>
 
 namespace render {
 
 namespace {
 
-void makeMagicBallImage(const std::filesystem::path &path, unsigned size) {
+sf::Image makeMagicBallImage(unsigned size) {
   using namespace sf;
 
   if (size == 0u)
@@ -86,11 +89,10 @@ void makeMagicBallImage(const std::filesystem::path &path, unsigned size) {
     }
   }
 
-  bool ok = img.saveToFile(path);
-  (void)ok;
+  return img;
 }
 
-void makeSwordRingImage(const std::filesystem::path &path, unsigned size) {
+sf::Image makeSwordRingImage(unsigned size) {
   using namespace sf;
 
   if (size == 0u)
@@ -127,22 +129,29 @@ void makeSwordRingImage(const std::filesystem::path &path, unsigned size) {
     }
   }
 
-  bool ok = img.saveToFile(path);
-  (void)ok;
+  return img;
 }
 
 } // namespace
 
-void generateWeaponTextures(unsigned magicBallSize, unsigned swordRingSize) {
-  namespace fs = std::filesystem;
+void registerWeaponTextures(
+    engine::ImageManager &images, engine::JobSystem &jobs, unsigned magicBallSize, unsigned swordRingSize) {
+  const std::string magicName{MAGIC_BALL_TEXTURE};
+  const std::string swordName{SWORD_RING_TEXTURE};
 
-  const fs::path magicPath{MAGIC_BALL_TEXTURE};
-  const fs::path swordPath{SWORD_RING_TEXTURE};
+  // Generated once per process; a restarted game loop reuses them.
+  if (images.findId(magicName).isValid() && images.findId(swordName).isValid())
+    return;
 
-  fs::create_directories(magicPath.parent_path());
+  sf::Image magicBall;
+  sf::Image swordRing;
+  engine::JobSystem::Counter counter;
+  jobs.submit([&]() { magicBall = makeMagicBallImage(magicBallSize); }, counter);
+  swordRing = makeSwordRingImage(swordRingSize);
+  jobs.wait(counter);
 
-  makeMagicBallImage(magicPath, magicBallSize);
-  makeSwordRingImage(swordPath, swordRingSize);
+  images.registerImage(magicName, std::move(magicBall));
+  images.registerImage(swordName, std::move(swordRing));
 }
 
 } // namespace render
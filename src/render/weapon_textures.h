@@ -2,16 +2,25 @@
 
 #include <string_view>
 
+namespace engine {
+class ImageManager;
+class JobSystem;
+} // namespace engine
+
 namespace render {
 
-inline constexpr std::string_view MAGIC_BALL_TEXTURE = "assets/runtime/projectiles/magic_ball.png";
-inline constexpr std::string_view SWORD_RING_TEXTURE = "assets/runtime/projectiles/sword_ring.png";
+// Names the generated textures are registered under in the ImageManager.
+inline constexpr std::string_view MAGIC_BALL_TEXTURE = "runtime/projectiles/magic_ball";
+inline constexpr std::string_view SWORD_RING_TEXTURE = "runtime/projectiles/sword_ring";
 
-// Generate textures for MagicStick and Sword on disk.
-// Always overwrites existing files with procedurally generated images.
+// Generate textures for MagicStick and Sword in memory, in parallel, and register them with `images`.
+// Nothing is written to disk; textures already registered are kept.
 // Default sizes: 32x32 for magic ball, 64x64 for sword ring.
-void generateWeaponTextures(unsigned magicBallSize, unsigned swordRingSize);
+void registerWeaponTextures(
+    engine::ImageManager &images, engine::JobSystem &jobs, unsigned magicBallSize, unsigned swordRingSize);
 
-inline void generateWeaponTextures() { generateWeaponTextures(32u, 64u); }
+inline void registerWeaponTextures(engine::ImageManager &images, engine::JobSystem &jobs) {
+  registerWeaponTextures(images, jobs, 32u, 64u);
+}
 
 } // namespace render
@@ -2,8 +2,10 @@
 
 #include "components.h"
 #include "core/camera.h"
+#include "ecs/collision.h"
 #include "ecs/components.h"
-#include "render/weapon_textures.h"
+#include "ecs/spatial_index.h"
+#include <algorithm>
 #include <cmath>
 
 float lengthSquared(const sf::Vector2f &v) { return v.x * v.x + v.y * v.y; }
@@ -24,21 +26,12 @@ bool isEntitiesIntersecting(const sf::Vector2f &posA,
   return rectA.findIntersection(rectB).has_value();
 }
 
-bool isWeaponHitEntity(const sf::Vector2f &projScreen,
-    float projRadius,
-    const sf::Vector2f &npcScreen,
-    const engine::Renderable &npcRender) {
+static sf::FloatRect npcHitbox(const sf::Vector2f &npcScreen, const engine::Renderable &npcRender) {
   float w = npcRender.targetSize.x;
   float h = npcRender.targetSize.y;
 
-  // Projectile: simple circle approximated by square.
-  sf::FloatRect projRect(
-      {projScreen.x - projRadius, projScreen.y - projRadius}, {projRadius * 2.f, projRadius * 2.f});
-
   // NPC hitbox: X in [0.1; 0.9], Y in [0.1; 0.9].
-  sf::FloatRect npcRect({npcScreen.x - w * 0.4f, npcScreen.y - h * 0.1f}, {w * 0.8f, h * 0.8f});
-
-  return projRect.findIntersection(npcRect).has_value();
+  return sf::FloatRect({npcScreen.x - w * 0.4f, npcScreen.y - h * 0.1f}, {w * 0.8f, h * 0.8f});
 }
 
 static void applyNpcCollisionDamage(
@@ -86,7 +79,7 @@ static void spawnLinearProjectile(entt::registry &registry,
 
   // Simple magic ball projectile.
   engine::Renderable render;
-  render.textureName = std::string(render::MAGIC_BALL_TEXTURE);
+  render.texture = weapon.projectileTexture;
   render.textureRect = sf::IntRect({0, 0}, {32, 32});
   render.targetSize = {18.f, 18.f};
   render.color = sf::Color::White;
@@ -126,7 +119,7 @@ static void spawnRadialEffect(entt::registry &registry,
   registry.emplace<engine::Velocity>(e, sf::Vector2f{0.f, 0.f});
 
   engine::Renderable render;
-  render.textureName = std::string(render::SWORD_RING_TEXTURE);
+  render.texture = weapon.projectileTexture;
   render.textureRect =
       sf::IntRect({0, 0}, {static_cast<int>(baseTextureSize), static_cast<int>(baseTextureSize)});
   render.targetSize = {sizePixels, sizePixels};
@@ -142,61 +135,54 @@ static void spawnRadialEffect(entt::registry &registry,
   registry.emplace<Projectile>(e, proj);
 }
 
-static void applyRadialDamage(
-    entt::registry &registry, const sf::Vector2f &origin, float radius, unsigned int damage) {
-  float radiusSq = radius * radius;
-  auto enemies = registry.view<engine::Position, HP>();
-
-  for (auto enemy : enemies) {
-    if (registry.all_of<engine::PlayerControlled>(enemy))
-      continue;
-
-    auto &hp = enemies.get<HP>(enemy);
-    const auto &pos = enemies.get<engine::Position>(enemy);
-
-    sf::Vector2f diff = pos.value - origin;
-    if (lengthSquared(diff) <= radiusSq) {
-      hp.current = hp.current > damage ? hp.current - damage : 0;
-    }
+static void applyRadialDamage(entt::registry &registry,
+    const engine::SpatialIndex &enemies,
+    const sf::Vector2f &origin,
+    float radius,
+    unsigned int damage) {
+  std::vector<entt::entity> hits;
+  enemies.queryRadius(origin, radius, hits);
+
+  for (auto enemy : hits) {
+    auto &hp = registry.get<HP>(enemy);
+    hp.current = hp.current > damage ? hp.current - damage : 0;
   }
 }
 
-static entt::entity findNearestEnemy(entt::registry &registry, const sf::Vector2f &origin, float radius) {
-  float radiusSq = radius * radius;
-  auto enemies = registry.view<engine::Position, HP>();
-
-  entt::entity best = entt::null;
-  float bestDistSq = radiusSq;
-
-  for (auto enemy : enemies) {
-    if (registry.all_of<engine::PlayerControlled>(enemy))
-      continue;
-
-    const auto &pos = enemies.get<engine::Position>(enemy);
-    sf::Vector2f diff = pos.value - origin;
-    float d2 = lengthSquared(diff);
-    if (d2 <= bestDistSq) {
-      bestDistSq = d2;
-      best = enemy;
-    }
-  }
-
-  return best;
+// World-space radius covering a screen-space square of half-size `reach`.
+static float screenReachToWorld(const engine::Camera &camera, float reach) {
+  sf::Vector2f a = camera.screenToWorld({reach, reach});
+  sf::Vector2f b = camera.screenToWorld({reach, -reach});
+  return std::sqrt(std::max(lengthSquared(a), lengthSquared(b)));
 }
 
 void gameMovementSystem(entt::registry &registry,
-    std::vector<engine::Tile> &tiles,
-    int worldWidth,
-    int worldHeight,
+    const engine::TileMap &tiles,
     float dt,
     double levelTime,
-    engine::Camera &camera) {
+    engine::Camera &camera,
+    engine::SpatialHashGrid &solidGrid) {
   auto view = registry.view<engine::Position, const engine::Velocity, const engine::Renderable>();
-  auto getIndex = [&](int x, int y) { return y * worldWidth + x; };
+  auto isSolid = [&](entt::entity e) { return registry.all_of<Solid>(e) && registry.get<Solid>(e).value; };
 
+  // Pick up spawns and positions changed by other systems; the largest solid bounds how far apart
+  // two overlapping hitboxes can be.
+  sf::Vector2f maxSolidSize{0.f, 0.f};
   for (auto entity : view) {
-    bool isSolidMover = registry.all_of<Solid>(entity) && registry.get<Solid>(entity).value;
+    if (!isSolid(entity)) {
+      solidGrid.remove(entity);
+      continue;
+    }
+    solidGrid.update(entity, view.get<engine::Position>(entity).value);
+    const auto &size = view.get<const engine::Renderable>(entity).targetSize;
+    maxSolidSize.x = std::max(maxSolidSize.x, size.x);
+    maxSolidSize.y = std::max(maxSolidSize.y, size.y);
+  }
 
+  std::vector<entt::entity> neighbours;
+
+  for (auto entity : view) {
+    bool isSolidMover = isSolid(entity);
     auto &pos = view.get<engine::Position>(entity);
     const auto &vel = view.get<const engine::Velocity>(entity);
     const auto &render = view.get<const engine::Renderable>(entity);
@@ -207,13 +193,7 @@ void gameMovementSystem(entt::registry &registry,
 
     // Get world position
     auto withinMap = [&](float newX, float newY) {
-      int tileX = static_cast<int>(std::floor(newX)) - 1;
-      int tileY = static_cast<int>(std::floor(newY));
-
-      if (tileX < 0 || tileX >= worldWidth || tileY < 0 || tileY >= worldHeight)
-        return false;
-
-      return !tiles[getIndex(tileX, tileY)].solid;
+      return tiles.isWalkable(static_cast<int>(std::floor(newX)) - 1, static_cast<int>(std::floor(newY)));
     };
 
     // Check collision with other entities, gets screen position. If player collides with enemy, apply damage
@@ -223,12 +203,14 @@ void gameMovementSystem(entt::registry &registry,
 
       sf::Vector2f move = newPosScreen - posScreen;
 
-      for (auto otherEntity : view) {
-        if (otherEntity == entity)
-          continue;
+      // Hitboxes are 0.5w x 0.3h boxes, so nothing further than this (in screen space) can be hit.
+      float reach = std::max((targetSize.x + maxSolidSize.x) * 0.25f,
+                        std::max(targetSize.y, maxSolidSize.y) * 0.3f) +
+                    std::abs(move.x) + std::abs(move.y);
+      solidGrid.query(camera.screenToWorld(posScreen), screenReachToWorld(camera, reach), neighbours);
 
-        bool isSolidOther = registry.all_of<Solid>(otherEntity) && registry.get<Solid>(otherEntity).value;
-        if (!isSolidOther)
+      for (auto otherEntity : neighbours) {
+        if (otherEntity == entity || !view.contains(otherEntity))
           continue;
 
         const auto &otherPos = view.get<engine::Position>(otherEntity);
@@ -262,42 +244,53 @@ void gameMovementSystem(entt::registry &registry,
       anchorPos.y += deltaWorld.y;
       pos.value.y += deltaWorld.y;
     }
+
+    if (isSolidMover)
+      solidGrid.update(entity, pos.value);
   }
 }
 
-void gameWeaponSystem(entt::registry &registry, float dt, engine::Camera &camera) {
+void gameWeaponSystem(entt::registry &registry,
+    float dt,
+    engine::Camera &camera,
+    engine::SpatialIndex &enemyIndex,
+    std::vector<engine::SpatialIndex::Hit> &hits) {
+  // Index every target once; all shots of all slots below query this snapshot.
+  enemyIndex.clear();
+  auto enemies = registry.view<const engine::Position, const HP>(entt::exclude<engine::PlayerControlled>);
+  for (auto enemy : enemies)
+    enemyIndex.add(enemy, enemies.get<const engine::Position>(enemy).value);
+  enemyIndex.build();
+
   auto playerView = registry.view<engine::Position, Weapons, engine::PlayerControlled>();
 
   for (auto entity : playerView) {
     auto &pos = playerView.get<engine::Position>(entity);
     auto &weapons = playerView.get<Weapons>(entity);
 
-    auto fireShot = [&](Weapon &weapon, entt::entity presetTarget = entt::null) {
-      if (weapon.type == ProjectileType::Linear) {
-        entt::entity target = presetTarget;
-        if (target == entt::null) {
-          target = findNearestEnemy(registry, pos.value, weapon.radius);
-          if (target == entt::null)
-            return;
-        }
-        const auto &targetPos = registry.get<engine::Position>(target);
-        spawnLinearProjectile(registry, camera, pos.value, targetPos.value, weapon);
-      } else if (weapon.type == ProjectileType::Radial) {
-        applyRadialDamage(registry, pos.value, weapon.radius, weapon.damage);
-        spawnRadialEffect(registry, camera, pos.value, weapon, 1.0f);
-      }
+    // One nearest query at the longest range serves every slot: if the closest enemy is out of a
+    // slot's range, nothing else is in range either.
+    float maxRadius = 0.f;
+    for (const auto &weapon : weapons.slots)
+      maxRadius = std::max(maxRadius, weapon.radius);
+    engine::SpatialIndex::Hit nearest = enemyIndex.nearest(pos.value, maxRadius, hits);
+
+    auto targetFor = [&](const Weapon &weapon) {
+      if (nearest.entity == entt::null || nearest.distanceSq > weapon.radius * weapon.radius)
+        return entt::entity{entt::null};
+      return nearest.entity;
     };
 
+    // Advances the slot's timers; true if it fires a shot this tick. Shots of one attack are spaced by
+    // shotInterval, so a slot never fires more than one per tick.
     auto updateWeapon = [&](Weapon &weapon) {
       if (weapon.shotsPerAttack == 0)
-        return;
+        return false;
 
       if (weapon.shotsPending > 0) {
         weapon.shotTimer -= dt;
         if (weapon.shotTimer > 0.f)
-          return;
-
-        fireShot(weapon);
+          return false;
 
         --weapon.shotsPending;
         if (weapon.shotsPending > 0) {
@@ -305,40 +298,61 @@ void gameWeaponSystem(entt::registry &registry, float dt, engine::Camera &camera
         } else {
           weapon.cooldownRemaining = weapon.cooldown;
         }
-        return;
+        return true;
       }
 
       if (weapon.cooldownRemaining > 0.f) {
         weapon.cooldownRemaining -= dt;
         if (weapon.cooldownRemaining > 0.f)
-          return;
+          return false;
         weapon.cooldownRemaining = 0.f;
       }
 
-      entt::entity target = findNearestEnemy(registry, pos.value, weapon.radius);
-      if (target == entt::null)
-        return;
-
-      weapon.shotsPending = weapon.shotsPerAttack;
-
-      fireShot(weapon, target);
+      if (targetFor(weapon) == entt::null)
+        return false;
 
-      --weapon.shotsPending;
+      weapon.shotsPending = weapon.shotsPerAttack - 1;
       if (weapon.shotsPending > 0) {
         weapon.shotTimer = weapon.shotInterval;
       } else {
         weapon.cooldownRemaining = weapon.cooldown;
       }
+      return true;
     };
 
-    updateWeapon(weapons.slots[0]);
-    updateWeapon(weapons.slots[1]);
+    for (auto &weapon : weapons.slots) {
+      if (!updateWeapon(weapon))
+        continue;
+
+      if (weapon.type == ProjectileType::Linear) {
+        entt::entity target = targetFor(weapon);
+        if (target == entt::null)
+          continue;
+        const auto &targetPos = registry.get<engine::Position>(target);
+        spawnLinearProjectile(registry, camera, pos.value, targetPos.value, weapon);
+      } else if (weapon.type == ProjectileType::Radial) {
+        applyRadialDamage(registry, enemyIndex, pos.value, weapon.radius, weapon.damage);
+        spawnRadialEffect(registry, camera, pos.value, weapon, 1.0f);
+      }
+    }
   }
 }
 
-void gameProjectileDamageSystem(entt::registry &registry, float dt, engine::Camera &camera) {
+void gameProjectileDamageSystem(
+    entt::registry &registry, float dt, engine::Camera &camera, engine::SweepAndPrune &npcHitboxes) {
   auto projView = registry.view<engine::Position, Projectile>();
 
+  // Screen-space hitboxes of all targets, shared by every projectile this tick.
+  npcHitboxes.clear();
+  auto npcView = registry.view<const engine::Position, const engine::Renderable, HP>(
+      entt::exclude<engine::PlayerControlled>);
+  for (auto npc : npcView) {
+    const auto &npcPos = npcView.get<const engine::Position>(npc);
+    const auto &npcRender = npcView.get<const engine::Renderable>(npc);
+    npcHitboxes.add(npc, npcHitbox(camera.worldToScreen(npcPos.value), npcRender));
+  }
+  npcHitboxes.build();
+
   std::vector<entt::entity> toDestroy;
 
   for (auto entity : projView) {
@@ -352,23 +366,16 @@ void gameProjectileDamageSystem(entt::registry &registry, float dt, engine::Came
     }
 
     if (proj.type == ProjectileType::Linear) {
-      auto npcView = registry.view<engine::Position, const engine::Renderable, HP>();
-
-      sf::Vector2f projPosScreen = camera.worldToScreen(pos.value);
-
-      for (auto npc : npcView) {
-        if (registry.all_of<engine::PlayerControlled>(npc))
-          continue;
-
-        const auto &npcPos = npcView.get<engine::Position>(npc);
-        const auto &npcRender = npcView.get<const engine::Renderable>(npc);
-
-        if (isWeaponHitEntity(projPosScreen, proj.radius, camera.worldToScreen(npcPos.value), npcRender)) {
-          auto &hp = npcView.get<HP>(npc);
-          hp.current = hp.current > proj.damage ? hp.current - proj.damage : 0;
-          toDestroy.push_back(entity);
-          break;
-        }
+      // Sweep the whole step of this tick so fast projectiles cannot pass through a target.
+      sf::Vector2f endScreen = camera.worldToScreen(pos.value);
+      sf::Vector2f startScreen = endScreen;
+      if (const auto *vel = registry.try_get<engine::Velocity>(entity))
+        startScreen -= vel->value * dt;
+
+      if (auto hit = npcHitboxes.sweep(startScreen, endScreen, proj.radius)) {
+        auto &hp = registry.get<HP>(hit->entity);
+        hp.current = hp.current > proj.damage ? hp.current - proj.damage : 0;
+        toDestroy.push_back(entity);
       }
     } else if (proj.type == ProjectileType::Radial) {
       auto &render = registry.get<engine::Renderable>(entity);
@@ -393,85 +400,77 @@ void gameProjectileDamageSystem(entt::registry &registry, float dt, engine::Came
   }
 }
 
-void gameAnimationSystem(entt::registry &registry, float dt) {
-  auto view = registry.view<engine::Animation, engine::Velocity, engine::Renderable>();
-
-  for (auto entity : view) {
-    auto &anim = view.get<engine::Animation>(entity);
-    auto &vel = view.get<engine::Velocity>(entity);
-    auto &render = view.get<engine::Renderable>(entity);
-
-    float moving = sqrtf(vel.value.x * vel.value.x + vel.value.y * vel.value.y);
-    engine::Direction newDir = anim.direction;
-    int newState = moving > 0.0f ? 1 : 0; // 0 - idle, 1 - walk
-
-    auto it = anim.clips.find(newState);
-    if (it == anim.clips.end())
-      continue;
-
-    const auto &clip = it->second;
-    if (clip.frameCount <= 1)
-      continue;
-
-    anim.frameTime += dt;
-
-    bool sideOnly = registry.all_of<SideViewOnly>(entity);
-    if (!moving) {
-      newDir = anim.direction;
-    } else if (std::abs(vel.value.y) > std::abs(vel.value.x) && !sideOnly) {
-      newDir = vel.value.y > 0.f ? engine::Direction::Down : engine::Direction::Up;
-    } else if (std::abs(vel.value.y) > std::abs(vel.value.x) && sideOnly) {
-      newDir = vel.value.x > 0.f ? engine::Direction::Left : engine::Direction::Right;
-    } else if (std::abs(vel.value.x) > std::abs(vel.value.y)) {
-      newDir = vel.value.x > 0.f ? engine::Direction::Left : engine::Direction::Right;
-    }
+void gameAnimationSystem(
+    entt::registry &registry, const engine::AnimationLibrary &animations, float dt, engine::JobSystem &jobs) {
+  auto view = registry.view<engine::Animation, const engine::Velocity, const engine::Renderable>();
+  std::vector<entt::entity> entities(view.begin(), view.end());
+
+  // Each entity only touches its own Animation, so chunks are independent.
+  jobs.parallelFor(entities.size(), 256, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      const entt::entity entity = entities[i];
+      auto &anim = view.get<engine::Animation>(entity);
+      const auto &vel = view.get<const engine::Velocity>(entity);
+
+      float moving = sqrtf(vel.value.x * vel.value.x + vel.value.y * vel.value.y);
+      engine::Direction newDir = anim.direction;
+      int newState = moving > 0.0f ? 1 : 0; // 0 - idle, 1 - walk
+
+      const engine::AnimationClip *clip = animations.get(anim.set).find(newState);
+      if (!clip || clip->frameCount <= 1)
+        continue;
+
+      anim.frameTime += dt;
+
+      bool sideOnly = registry.all_of<SideViewOnly>(entity);
+      if (!moving) {
+        newDir = anim.direction;
+      } else if (std::abs(vel.value.y) > std::abs(vel.value.x) && !sideOnly) {
+        newDir = vel.value.y > 0.f ? engine::Direction::Down : engine::Direction::Up;
+      } else if (std::abs(vel.value.y) > std::abs(vel.value.x) && sideOnly) {
+        newDir = vel.value.x > 0.f ? engine::Direction::Left : engine::Direction::Right;
+      } else if (std::abs(vel.value.x) > std::abs(vel.value.y)) {
+        newDir = vel.value.x > 0.f ? engine::Direction::Left : engine::Direction::Right;
+      }
 
-    if (anim.direction != newDir || anim.state != newState) {
-      anim.state = newState;
-      anim.direction = newDir;
-      anim.row = static_cast<int>(newDir);
-      anim.frameIdx = 0;
-      anim.frameTime = 0.f;
-    }
+      if (anim.direction != newDir || anim.state != newState) {
+        anim.state = newState;
+        anim.direction = newDir;
+        anim.row = static_cast<int>(newDir);
+        anim.frameIdx = 0;
+        anim.frameTime = 0.f;
+      }
 
-    while (anim.frameTime >= clip.frameDuration) {
-      anim.frameTime -= clip.frameDuration;
-      anim.frameIdx = (anim.frameIdx + 1) % clip.frameCount;
+      while (anim.frameTime >= clip->frameDuration) {
+        anim.frameTime -= clip->frameDuration;
+        anim.frameIdx = (anim.frameIdx + 1) % clip->frameCount;
+      }
     }
-  }
+  });
 }
 
-void gameInputSystem(entt::registry &registry, const engine::Input &input, float &gameSpeed) {
+void gameInputSystem(
+    entt::registry &registry, const engine::Input &input, engine::KeyPresses &presses, float &gameSpeed) {
   auto view = registry.view<engine::Velocity, engine::Speed, engine::PlayerControlled, engine::Animation>();
 
-  static bool plusPrev = false;
-  static bool minusPrev = false;
-  static bool escPrev = false;
+  presses.update(input);
 
-  bool plusNow = input.isKeyDown(sf::Keyboard::Key::Equal);   // '=' / '+'
-  bool minusNow = input.isKeyDown(sf::Keyboard::Key::Hyphen); // '-' / '_'
-  bool escNow = input.isKeyDown(sf::Keyboard::Key::Escape);
-
-  if (plusNow && !plusPrev) {
+  if (presses.isPressed(sf::Keyboard::Key::Equal)) { // '=' / '+'
     float next = gameSpeed <= 0.f ? 1.f : gameSpeed + 1.f;
     if (next > 8.f)
       next = 8.f;
     gameSpeed = next;
   }
-  if (minusNow && !minusPrev && gameSpeed > 0.f) {
+  if (presses.isPressed(sf::Keyboard::Key::Hyphen) && gameSpeed > 0.f) { // '-' / '_'
     float next = gameSpeed - 1.f;
     if (next < 1.f)
       next = 1.f;
     gameSpeed = next;
   }
-  if (escNow && !escPrev) {
+  if (presses.isPressed(sf::Keyboard::Key::Escape)) {
     gameSpeed = (gameSpeed == 0.f) ? 1.f : 0.f;
   }
 
-  plusPrev = plusNow;
-  minusPrev = minusNow;
-  escPrev = escNow;
-
   for (auto entity : view) {
     auto &vel = view.get<engine::Velocity>(entity);
     auto &anim = view.get<engine::Animation>(entity);
@@ -5,22 +5,37 @@
 
 #include "core/camera.h"
 #include "core/input.h"
+#include "core/job_system.h"
+#include "ecs/collision.h"
 #include "ecs/components.h"
-#include "ecs/tile.h"
+#include "ecs/spatial_grid.h"
+#include "ecs/spatial_index.h"
+#include "ecs/tile_map.h"
+#include "resources/animation_library.h"
 
 void gameMovementSystem(entt::registry &registry,
-    std::vector<engine::Tile> &tiles,
-    int worldWidth,
-    int worldHeight,
+    const engine::TileMap &tiles,
     float dt,
     double levelTime,
-    engine::Camera &camera);
+    engine::Camera &camera,
+    engine::SpatialHashGrid &solidGrid);
 
-void gameAnimationSystem(entt::registry &registry, float dt);
-void gameInputSystem(entt::registry &registry, const engine::Input &input, float &gameSpeed);
+void gameAnimationSystem(
+    entt::registry &registry, const engine::AnimationLibrary &animations, float dt, engine::JobSystem &jobs);
+// presses carries the keys held in the previous step, for the speed and pause toggles.
+void gameInputSystem(
+    entt::registry &registry, const engine::Input &input, engine::KeyPresses &presses, float &gameSpeed);
 
 // Handles all player weapons (projectile + radial) in a single system.
-void gameWeaponSystem(entt::registry &registry, float dt, engine::Camera &camera);
+// Rebuilds enemyIndex from all non-player HP entities and uses it for targeting and area damage.
+// hits is scratch space for the nearest-enemy queries, reused across calls.
+void gameWeaponSystem(entt::registry &registry,
+    float dt,
+    engine::Camera &camera,
+    engine::SpatialIndex &enemyIndex,
+    std::vector<engine::SpatialIndex::Hit> &hits);
 
 // Updates projectiles (lifetime) and applies their damage to NPCs.
-void gameProjectileDamageSystem(entt::registry &registry, float dt, engine::Camera &camera);
+// Linear projectiles sweep their whole step against npcHitboxes, which is rebuilt every call.
+void gameProjectileDamageSystem(
+    entt::registry &registry, float dt, engine::Camera &camera, engine::SweepAndPrune &npcHitboxes);